@@ -1,47 +1,237 @@
 #include "XenonArgumentParser.h"
 #include <stdlib.h>
-#include <iostream>
+#include <stdio.h>
 #include <cstring>
+#include <cerrno>
 #include <cassert>
-#include <memory>
-#include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+	#define ARGUMENT_PARSER_POSIX
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	
+	extern char **environ;
+#else
+	// Without POSIX, files are read instead of mapped, and output goes through stdio
+	#define STDOUT_FILENO 1
+	#define STDERR_FILENO 2
+#endif
 
 namespace Xenon {
 namespace ArgumentParser {
 
-void printEnumValues (std::ostream &out, const char * const *ev, char delim = ' ') {
+template<class Out>
+void printEnumValues (Out &out, const char * const *ev, char delim = ' ') {
 	out << delim << *(ev++) << delim;
 	for (; *ev; ++ev)
 		out << "," << delim << *ev << delim;
 }
 
+// Errors:
+
+#ifndef ARGUMENT_PARSER_NO_EXCEPTIONS
+void raiseError (const char *message) {
+	throw ArgumentParserError (message);
+}
+
+void raiseRequiredArgumentMissing (const char *arg) {
+	throw RequiredArgumentMissing (arg);
+}
+
+void raiseLogicError (const char *message) {
+	throw std::logic_error (message);
+}
+#else
+static void defaultErrorHandler (ErrorKind kind, const char *message) {
+	FdOutputSink err (STDERR_FILENO);
+	err.write (message, strlen(message));
+	err.write ("\n", 1);
+	if (kind == Error_Logic)
+		abort ();
+	exit (EXIT_FAILURE);
+}
+
+static ErrorHandler errorHandler = &defaultErrorHandler;
+
+ErrorHandler setErrorHandler (ErrorHandler handler) {
+	ErrorHandler prev = errorHandler;
+	errorHandler = handler ? handler : &defaultErrorHandler;
+	return prev;
+}
+
+[[noreturn]] static void callErrorHandler (ErrorKind kind, const char *message) {
+	errorHandler (kind, message);
+	abort (); // Handler must not return
+}
+
+void raiseError (const char *message) {
+	callErrorHandler (Error_Argument, message);
+}
+
+void raiseRequiredArgumentMissing (const char *arg) {
+	callErrorHandler (Error_RequiredArgumentMissing, (ErrorMessage() << "Missing required argument '" << arg << "'").c_str());
+}
+
+void raiseLogicError (const char *message) {
+	callErrorHandler (Error_Logic, message);
+}
+#endif
+
+// Output:
+
+void FdOutputSink::write (const char *data, size_t length) {
+#ifndef ARGUMENT_PARSER_POSIX
+	fwrite (data, 1, length, (fd == STDERR_FILENO) ? stderr : stdout);
+#else
+	while (length > 0) {
+		const ssize_t n = ::write (fd, data, length);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+		data += n;
+		length -= n;
+	}
+#endif
+}
+
+void OutputWriter::write (const char *data, size_t length) {
+	if (used + length > sizeof(buffer)) {
+		flush ();
+		if (length > sizeof(buffer)) {
+			sink.write (data, length);
+			return;
+		}
+	}
+	memcpy (&buffer[used], data, length);
+	used += length;
+}
+
+void OutputWriter::flush () {
+	if (used > 0)
+		sink.write (buffer, used);
+	used = 0;
+	sink.flush ();
+}
+
+OutputWriter &OutputWriter::operator<< (long long v) {
+	char buf[24];
+	write (buf, snprintf (buf, sizeof(buf), "%lld", v));
+	return *this;
+}
+
+OutputWriter &OutputWriter::operator<< (double v) {
+	char buf[32];
+	const int n = snprintf (buf, sizeof(buf), "%g", v);
+	write (buf, std::min<size_t> (n, sizeof(buf) - 1));
+	return *this;
+}
+
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+/// @brief Owns a read-only memory mapping of a file, or a copy of some data; Shared between all FileView objects referring to it
+struct FileMapping {
+	void *addr;
+	size_t size;
+	bool mapped;
+	
+	FileMapping (void *addr, size_t size, bool mapped) : addr(addr), size(size), mapped(mapped) { }
+	~FileMapping () {
+#ifdef ARGUMENT_PARSER_POSIX
+		if (mapped) {
+			munmap (addr, size);
+			return;
+		}
+#endif
+		::operator delete (addr);
+	}
+};
+
+bool FileView::isMapped () const {
+	return mapping && mapping->mapped;
+}
+
+FileView FileView::copy (const char *s, size_t n) {
+	if (n == 0)
+		return FileView ();
+	std::shared_ptr<FileMapping> mapping = std::make_shared<FileMapping> ((void *)NULL, n, false);
+	mapping->addr = ::operator new (n);
+	memcpy (mapping->addr, s, n);
+	return FileView (static_cast<const char *> (mapping->addr), n, mapping);
+}
+
+#ifdef ARGUMENT_PARSER_POSIX
+static FileView mapFile (const char *path, const OptionDesc &desc) {
+	const int fd = open (path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		raiseError ( ErrorMessage() << "OptionsParser: Could not open file '" << path << "' for parameter '" << desc.name << "': " << strerror(errno));
+	struct stat st;
+	if (fstat (fd, &st) != 0 || !S_ISREG (st.st_mode)) {
+		close (fd);
+		raiseError ( ErrorMessage() << "OptionsParser: '" << path << "' given for parameter '" << desc.name << "' is not a regular file");
+	}
+	if (st.st_size == 0) { // Empty files can not be mapped
+		close (fd);
+		return FileView ();
+	}
+	void *addr = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (addr == MAP_FAILED)
+		raiseError ( ErrorMessage() << "OptionsParser: Could not map file '" << path << "' for parameter '" << desc.name << "': " << strerror(errno));
+	std::shared_ptr<const FileMapping> mapping = std::make_shared<const FileMapping> (addr, st.st_size, true);
+	return FileView (static_cast<const char *> (addr), st.st_size, mapping);
+}
+#else
+/// Without mmap, the contents are read into storage owned by the view
+static FileView mapFile (const char *path, const OptionDesc &desc) {
+	FILE *f = fopen (path, "rb");
+	if (!f)
+		raiseError ( ErrorMessage() << "OptionsParser: Could not open file '" << path << "' for parameter '" << desc.name << "': " << strerror(errno));
+	std::vector<char> contents;
+	char buf[4096];
+	for (size_t n; (n = fread (buf, 1, sizeof(buf), f)) > 0; )
+		contents.insert (contents.end(), buf, buf + n);
+	const bool failed = ferror (f);
+	fclose (f);
+	if (failed)
+		raiseError ( ErrorMessage() << "OptionsParser: Could not read file '" << path << "' for parameter '" << desc.name << "'");
+	return contents.empty() ? FileView () : FileView::copy (&contents[0], contents.size());
+}
+#endif
+#endif
+
 namespace ParseFunctions {
 
 bool check (const char *argValue, const OptionDesc &desc) {
 	if (!argValue) {
 		if (desc.flags & Options_Flag)
 			return false; // Use default
-		throw ArgumentParserError ( std::string("OptionsParser: Missing argument for parameter '") + std::string(desc.name));
+		raiseError ( ErrorMessage() << "OptionsParser: Missing argument for parameter '" << desc.name);
 	}
 	if (desc.enumeration_values) {
 		for (const char * const *ev = desc.enumeration_values; *ev; ++ev) {
 			if ( strcmp (*ev, argValue) == 0)
 				return true;
 		}
-		std::stringstream s;
+		ErrorMessage s;
 		s << "OptionsParser: Invalid argument for parameter '" << desc.name << "'. Valid arguments are: ";
 		printEnumValues (s, desc.enumeration_values);
-		throw ArgumentParserError ( s.str() );
+		raiseError ( s );
 	}
 	return true;
 }
 
+#ifndef ARGUMENT_PARSER_NO_STRING
 void parse ( std::string &p, const char *argValue, const OptionDesc &desc )
 {
 	if (!check (argValue, desc)) return;
 	p.assign (argValue);
 }
+#endif
 
 void parse ( const char * &p, const char *argValue, const OptionDesc &desc )
 {
@@ -49,6 +239,17 @@ void parse ( const char * &p, const char *argValue, const OptionDesc &desc )
 	p = argValue;
 }
 
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+void parse ( FileView &p, const char *argValue, const OptionDesc &desc )
+{
+	if (!check (argValue, desc)) return;
+	if (FileView::isFileReference (argValue))
+		p = mapFile (&argValue[1], desc);
+	else
+		p = FileView ( (argValue[0] == '@') ? &argValue[1] : argValue );
+}
+#endif
+
 void parse ( int32_t &p, const char *argValue, const OptionDesc &desc ) {
 	int64_t tmp;
 	parse (tmp, argValue, desc);
@@ -60,7 +261,7 @@ void parse ( int64_t &p, const char *argValue, const OptionDesc &desc ) {
 	char *e;
 	p = strtol (argValue, &e, 10);
 	if (e == argValue || *e != '\0')
-		throw ArgumentParserError ( std::string("OptionsParser: Could not parse argument '") + std::string(desc.name) + "'. Not a valid number");
+		raiseError ( ErrorMessage() << "OptionsParser: Could not parse argument '" << desc.name << "'. Not a valid number");
 }
 
 void parse ( float &p, const char *argValue, const OptionDesc &desc ) {
@@ -68,13 +269,13 @@ void parse ( float &p, const char *argValue, const OptionDesc &desc ) {
 	char *e;
 	p = strtof (argValue, &e);
 	if (e == argValue || *e != '\0')
-		throw ArgumentParserError ( std::string("OptionsParser: Could not parse argument '") + std::string(desc.name) + "'. Not a valid floating-point number");
+		raiseError ( ErrorMessage() << "OptionsParser: Could not parse argument '" << desc.name << "'. Not a valid floating-point number");
 }
 
 void parse ( bool &p, const char *argValue, const OptionDesc &desc ) {
 	if (!argValue) {
 		if ( (desc.flags & Options_Flag) == 0)
-			throw ArgumentParserError ( std::string("OptionsParser: Missing argument for parameter '") + std::string(desc.name));
+			raiseError ( ErrorMessage() << "OptionsParser: Missing argument for parameter '" << desc.name);
 		p = true;
 		return;
 	}
@@ -84,13 +285,13 @@ void parse ( bool &p, const char *argValue, const OptionDesc &desc ) {
 		else if ( argValue[0] == '0')
 			p = false;
 		else
-			throw ArgumentParserError ( std::string("OptionsParser: Could not parse argument '") + std::string(desc.name) + "'. Not a valid boolean value");
+			raiseError ( ErrorMessage() << "OptionsParser: Could not parse argument '" << desc.name << "'. Not a valid boolean value");
 	} else if (strcmp (argValue, "true") == 0) {
 		p = true;
 	} else if (strcmp (argValue, "false") == 0) {
 		p = false;
 	} else
-		throw ArgumentParserError ( std::string("OptionsParser: Could not parse argument '") + std::string(desc.name) + "'. Not a valid boolean value");
+		raiseError ( ErrorMessage() << "OptionsParser: Could not parse argument '" << desc.name << "'. Not a valid boolean value");
 }
 
 // Help:
@@ -136,12 +337,19 @@ template<class T> void printHelpImpl (OHP &hp,  const OptionDesc &desc, const T
 	
 }
 
+#ifndef ARGUMENT_PARSER_NO_STRING
 void print_help (OHP &hp, const OptionDesc &desc, const std::string &, const std::string &defVal) {
 	printHelpImpl (hp, desc, defVal, '"');
 }
-void print_help (OHP &hp, const OptionDesc &desc, const char* &, const char * &defVal) {
+#endif
+void print_help (OHP &hp, const OptionDesc &desc, const char * const &, const char * const &defVal) {
+	printHelpImpl (hp, desc, defVal, '"');
+}
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+void print_help (OHP &hp, const OptionDesc &desc, const FileView &, const FileView &defVal) {
 	printHelpImpl (hp, desc, defVal, '"');
 }
+#endif
 void print_help (OHP &hp, const OptionDesc &desc, int, int defVal) {
 	printHelpImpl (hp, desc, defVal);
 }
@@ -153,18 +361,99 @@ void print_help (OHP &hp, const OptionDesc &desc, bool, bool defVal) {
 }
 }
 
-void OptionParserBase::printHelpHead (std::ostream &out, const AppInformation &appInfos) {
+void OptionParserBase::printHelpHead (OutputWriter &out, const AppInformation &appInfos) {
 	if (appInfos.usage)
-		out << appInfos.usage << std::endl;
+		out << appInfos.usage << '\n';
 	else
-		out << appInfos.programName << " " << appInfos.programVersion << std::endl;
+		out << appInfos.programName << " " << appInfos.programVersion << '\n';
 	if (appInfos.programHelpTextHeader)
 		out << appInfos.programHelpTextHeader;
-	out << std::endl;
+	out << '\n';
+}
+
+void OptionParserBase::printHelp (OutputSink &sink, bool full, const AppInformation &appInfo) {
+	OutputWriter out (sink);
+	printHelpHead (out, appInfo);
+	HelpPrinter printer (out, appInfo, full);
+	this->_opt_printOptions (printer);
+	if (appInfo.programHelpTextTail)
+		out << appInfo.programHelpTextTail;
+	out << '\n';
+}
+
+/// @brief Calls f with the sink for help and version output configured in appInfos
+template<class F>
+static void withOutputSink (const AppInformation &appInfos, F f) {
+	if (appInfos.helpOutput)
+		return f (*appInfos.helpOutput);
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+	OStreamSink sink (appInfos.helpOutputStream ? *appInfos.helpOutputStream : std::cout);
+#else
+	FdOutputSink sink (STDOUT_FILENO);
+#endif
+	f (sink);
 }
 
 //
 
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+static inline bool isCommandSpace (char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+int CommandTokenizer::tokenize (const char *cmdline, size_t length, const char *argv0)
+{
+	// Unquoting never makes an argument longer than its source, and each terminator replaces a separator,
+	// so one byte more than the command string is always enough.
+	if (buffer.size() < length + 1)
+		buffer.resize (length + 1);
+	args.clear ();
+	args.push_back (const_cast<char *> (argv0));
+	
+	char *out = &buffer[0];
+	const char *s = cmdline, * const end = cmdline + length;
+	for (;;) {
+		while (s < end && isCommandSpace (*s))
+			++s;
+		if (s == end)
+			break;
+		args.push_back (out);
+		char quote = '\0';
+		for (; s < end; ++s) {
+			const char c = *s;
+			if (quote == '\'') {
+				if (c == '\'')
+					quote = '\0';
+				else
+					*(out++) = c;
+			} else if (c == '\\') {
+				if (++s == end)
+					raiseError("OptionsParser: Command string ends with an escape character");
+				if (quote == '"' && !strchr ("\"\\$`\n", *s)) // Backslash is kept within double quotes
+					*(out++) = '\\';
+				if (*s != '\n') // Escaped newline continues the line
+					*(out++) = *s;
+			} else if (quote == '"') {
+				if (c == '"')
+					quote = '\0';
+				else
+					*(out++) = c;
+			} else if (c == '\'' || c == '"') {
+				quote = c;
+			} else if (isCommandSpace (c)) {
+				break;
+			} else
+				*(out++) = c;
+		}
+		if (quote)
+			raiseError("OptionsParser: Unterminated quote in command string");
+		*(out++) = '\0';
+	}
+	args.push_back (NULL);
+	return args.size() - 1;
+}
+#endif
+
 static void evalSelectedOption (const OptionDesc &selectedArg, char *nActiveGroupOptions, const OptionGroup **groups, const int maxGroups) {
 	if (selectedArg.assignedGroup) {
 		const OptionGroup **g = std::lower_bound (&groups[0], &groups[maxGroups], selectedArg.assignedGroup);
@@ -186,16 +475,17 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 	std::sort (&groups[0], lastGroupPtr);
 	for (const OptionGroup *prev = NULL, **g = &groups[0]; g < lastGroupPtr; prev = *(g++)) {
 		if (prev == *g)
-			throw std::logic_error ("ArgumentParser: Multiple options within the same OptionGroup must appear in consecutive declaration order.");
+			raiseLogicError ("ArgumentParser: Multiple options within the same OptionGroup must appear in consecutive declaration order.");
 	}
 	
 	uint32_t numPositionalArgs = 0U;
 	bool evalArgs = true;
 	for (int iArg = 1; iArg < argc; ++iArg)
 	{
+		_opt_origin.position = (iArg < 0xFFFF) ? iArg : 0xFFFF;
 		const char *thisArg = argv[iArg];
 		if (!thisArg[0] || (thisArg[0] == '-' && thisArg[1] == '\0'))
-			throw ArgumentParserError("Invalid argument syntax");
+			raiseError("Invalid argument syntax");
 		
 		OptionDesc selectedArg (NULL, 0);
 		if (evalArgs && thisArg[0] == '-' && thisArg[1] == '-') // Long option
@@ -223,20 +513,23 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 					++iArg;
 			}
 			else if ( (appInfos.programOptions & NoHelp) == 0 && strcmp (thisArg, "help") == 0) {
-				printHelp (std::cout, false, appInfos);
+				withOutputSink (appInfos, [&] (OutputSink &out) { printHelp (out, false, appInfos); });
 				return PARSE_TERMINATE;
 			}
 			else if ( (appInfos.programOptions & NoHelp) == 0 && strcmp (thisArg, "full-help") == 0) {
-				printHelp (std::cout, (appInfos.programOptions & HideHidden) == 0, appInfos);
+				withOutputSink (appInfos, [&] (OutputSink &out) { printHelp (out, (appInfos.programOptions & HideHidden) == 0, appInfos); });
 				return PARSE_TERMINATE;
 			}
 			else if ( (appInfos.programOptions & NoVersion) == 0 && strcmp (thisArg, "version") == 0) {
-				std::cout << appInfos.programName << " - " << appInfos.programVersion << std::endl;
+				withOutputSink (appInfos, [&] (OutputSink &sink) {
+					OutputWriter out (sink);
+					out << appInfos.programName << " - " << appInfos.programVersion << '\n';
+				});
 				return PARSE_TERMINATE;
 			}
 			else {
 				if (!(appInfos.programOptions & IgnoreUnknown))
-					throw ArgumentParserError(std::string("Unknown argument: ") + thisArg);
+					raiseError(ErrorMessage() << "Unknown argument: " << thisArg);
 			}
 		} else if (evalArgs && thisArg[0] == '-' && thisArg[1] != '-' && thisArg[1] != '\0') // Short option
 		{
@@ -244,7 +537,7 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 				const char *argValue = (argc > iArg+1) ? argv[iArg+1] : NULL;
 				if (!_opt_parseShortArgument (thisArg[1], argValue, &selectedArg)) {
 					if (!(appInfos.programOptions & IgnoreUnknown))
-						throw ArgumentParserError(std::string("Unknown short-form argument: ") + thisArg[1]);
+						raiseError(ErrorMessage() << "Unknown short-form argument: " << thisArg[1]);
 				}
 				if (!(selectedArg.flags & Options_Flag) && argValue)
 					++iArg;
@@ -255,7 +548,7 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 					OptionDesc selectedArg (NULL, 0);
 					if (!_opt_parseShortArgument (*s, NULL, &selectedArg)) {
 						if (!(appInfos.programOptions & IgnoreUnknown))
-							throw ArgumentParserError(std::string("Unknown short-form argument: ") + *s);
+							raiseError(ErrorMessage() << "Unknown short-form argument: " << *s);
 					}
 					assert (selectedArg.flags & Options_Flag);
 					evalSelectedOption (selectedArg, nActiveGroupOtions, groups, lastGroupPtr - &groups[0]);
@@ -264,7 +557,7 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 		}
 		else  {
 			if (iArg >= 0xFFFE || numPositionalArgs >= (maxPosArgs-1) )
-				throw ArgumentParserError("Too many positional arguments given.");
+				raiseError("Too many positional arguments given.");
 			positionalArgs[numPositionalArgs++] = iArg;
 		}
 		if (selectedArg.description)
@@ -272,15 +565,202 @@ OptionParserBase::ParseResult OptionParserBase::parse (int argc, char **argv, co
 	}
 	this->_opt_checkArguments(argv, numPositionalArgs, positionalArgs, appInfos);
 	for (const OptionGroup **g = &groups[0]; g < lastGroupPtr; ++g)
+		checkGroup (*g, nActiveGroupOtions[ g - &groups[0] ], appInfos);
+	return PARSE_OK;
+}
+
+void OptionParserBase::checkGroup (const OptionGroup *group, unsigned int nActiveOptions, const AppInformation &appInfos)
+{
+	if (!group)
+		return;
+	if ( group->flags & Group_Required && nActiveOptions < 1 && !(appInfos.programOptions & PartialArguments))
+		raiseError(ErrorMessage() << "No option chosen for mandatory OptionGroup '" << group->desc << "'");
+	
+	if ( group->flags & Group_Exclusive && nActiveOptions > 1)
+		raiseError(ErrorMessage() << "Only one option may be chosen for OptionGroup '" << group->desc << "'");
+}
+
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+// Layered sources:
+
+uint16_t LayeredSources::add (Source &&src) {
+	if (sources.size() >= 0xFFFE)
+		raiseLogicError ("ArgumentParser: Too many option sources");
+	sources.push_back (std::move (src));
+	return sources.size();
+}
+
+uint16_t LayeredSources::addArguments (int argc, char **argv, const char *name) {
+	Source src (name);
+	src.argc = argc;
+	src.argv = argv;
+	return add (std::move (src));
+}
+
+static inline bool isConfigSpace (char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+uint16_t LayeredSources::addConfigFile (const char *path, bool mustExist) {
+	Source src (path);
+	FILE *f = fopen (path, "r");
+	if (!f) {
+		if (mustExist || errno != ENOENT)
+			raiseError ( ErrorMessage() << "OptionsParser: Could not open config file '" << path << "': " << strerror(errno));
+		return add (std::move (src));
+	}
+	char buf[4096];
+	for (size_t n; (n = fread (buf, 1, sizeof(buf), f)) > 0; )
+		src.text.insert (src.text.end(), buf, buf + n);
+	fclose (f);
+	src.text.push_back ('\0');
+	
+	// Split into name/value pairs in place
+	uint16_t line = 0;
+	for (char *s = &src.text[0], *textEnd = s + src.text.size() - 1; s < textEnd; ) {
+		char *lineEnd = static_cast<char *> (memchr (s, '\n', textEnd - s));
+		if (!lineEnd)
+			lineEnd = textEnd;
+		*lineEnd = '\0';
+		if (line < 0xFFFF)
+			++line;
+		while (isConfigSpace (*s))
+			++s;
+		if (*s && *s != '#') {
+			Entry e;
+			e.name = s - &src.text[0];
+			e.position = line;
+			while (*s && *s != '=' && !isConfigSpace (*s))
+				++s;
+			char *nameEnd = s;
+			while (isConfigSpace (*s))
+				++s;
+			bool hasValue = (*s == '=');
+			if (hasValue)
+				++s;
+			*nameEnd = '\0';
+			while (isConfigSpace (*s))
+				++s;
+			char *valueEnd = lineEnd;
+			while (valueEnd > s && isConfigSpace (valueEnd[-1]))
+				--valueEnd;
+			hasValue |= (s < valueEnd);
+			if (valueEnd - s >= 2 && *s == '"' && valueEnd[-1] == '"') {
+				++s;
+				--valueEnd;
+			}
+			*valueEnd = '\0';
+			e.value = hasValue ? (s - &src.text[0]) : NoValue;
+			src.entries.push_back (e);
+		}
+		s = lineEnd + 1;
+	}
+	return add (std::move (src));
+}
+
+uint16_t LayeredSources::addEnvironment (const char *prefix, char **envp) {
+	Source src ("environment");
+	src.isEnvironment = true;
+	const size_t prefixLen = strlen (prefix);
+	if (!envp) {
+#if defined(ARGUMENT_PARSER_POSIX)
+		envp = environ;
+#elif defined(_WIN32)
+		envp = _environ;
+#else
+		raiseLogicError ("ArgumentParser: The environment can not be enumerated on this platform; Pass envp");
+#endif
+	}
+	for (size_t i = 0; envp[i]; ++i) {
+		const char *var = envp[i], *sep = strchr (var, '=');
+		if (!sep || strncmp (var, prefix, prefixLen) != 0 || sep == var + prefixLen)
+			continue;
+		Entry e;
+		e.position = (i < 0xFFFF) ? i : 0xFFFF;
+		e.name = src.text.size();
+		for (const char *c = var + prefixLen; c < sep; ++c) // MYAPP_LOG_LEVEL -> log_level
+			src.text.push_back (tolower ((unsigned char)*c));
+		src.text.push_back ('\0');
+		e.value = src.text.size();
+		src.text.insert (src.text.end(), sep + 1, sep + strlen(sep) + 1);
+		src.entries.push_back (e);
+	}
+	return add (std::move (src));
+}
+
+/// @brief Restores the state for plain parsing when applying layered sources is finished or aborted
+struct LayeredParseState {
+	LayeredParseState (uint64_t &locked, Provenance *&provenance, bool &deferChecks)
+		: locked(locked), provenance(provenance), deferChecks(deferChecks) { }
+	~LayeredParseState () {
+		locked = 0;
+		provenance = NULL;
+		deferChecks = false;
+	}
+	uint64_t &locked;
+	Provenance *&provenance;
+	bool &deferChecks;
+};
+
+OptionParserBase::ParseResult OptionParserBase::parse (LayeredSources &sources, const uint64_t &setParameters, const AppInformation &appInfos)
+{
+	memset (sources.provenance, 0, sizeof(sources.provenance));
 	{
-		if ( (*g)->flags & Group_Required && nActiveGroupOtions[ g - &groups[0] ] < 1)
-			throw ArgumentParserError(std::string("No option chosen for mandatory OptionGroup '") + (*g)->desc + "'");
+		LayeredParseState state (_opt_lockedParameters, _opt_provenance, _opt_deferChecks);
+		_opt_provenance = sources.provenance;
+		_opt_deferChecks = true;
+		AppInformation partialInfo (appInfos);
+		partialInfo.programOptions |= PartialArguments;
 		
-		if ( (*g)->flags & Group_Exclusive && nActiveGroupOtions[ g - &groups[0] ] > 1)
-			throw ArgumentParserError(std::string("Only one option may be chosen for OptionGroup '") + (*g)->desc + "'");
+		// Highest priority first; Each source skips the options set before, as well as the other
+		// options of exclusive groups in which an option is set
+		for (size_t i = sources.sources.size(); i-- > 0; ) {
+			_opt_lockedParameters = setParameters | this->_opt_exclusiveGroupParameters (setParameters);
+			_opt_origin.source = i + 1;
+			if (sources.sources[i].argv) {
+				if (parse (sources.sources[i].argc, sources.sources[i].argv, partialInfo) == PARSE_TERMINATE)
+					return PARSE_TERMINATE;
+			} else
+				applyEntries (sources, i, appInfos);
+		}
 	}
+	this->_opt_checkArguments (NULL, 0, NULL, appInfos);
+	this->_opt_checkGroups (appInfos);
 	return PARSE_OK;
 }
 
+void OptionParserBase::applyEntries (const LayeredSources &sources, size_t sourceIndex, const AppInformation &appInfos)
+{
+	const LayeredSources::Source &src = sources.sources[sourceIndex];
+	static const int maxGroups = 32;
+	char nActiveGroupOptions[maxGroups];
+	memset (&nActiveGroupOptions[0], 0, maxGroups);
+	const OptionGroup *groups[ maxGroups ], **lastGroupPtr = &groups[0];
+	this->_opt_enumerateGroups (lastGroupPtr, maxGroups);
+	std::sort (&groups[0], lastGroupPtr);
+	
+	for (const LayeredSources::Entry &e : src.entries) {
+		const char *name = &src.text[e.name];
+		const char *value = (e.value != LayeredSources::NoValue) ? &src.text[e.value] : NULL;
+		OptionDesc selectedArg (NULL, 0);
+		_opt_origin.position = e.position;
+		if (_opt_parseLongArgument (name, value, &selectedArg, PARSE_ATTRIBUTE_NAME)) {
+			evalSelectedOption (selectedArg, nActiveGroupOptions, groups, lastGroupPtr - &groups[0]);
+			continue;
+		}
+		if (!src.isEnvironment && !(appInfos.programOptions & IgnoreUnknown)) {
+			char line[8];
+			snprintf (line, sizeof(line), "%u", (unsigned int)e.position);
+			raiseError(ErrorMessage() << "Unknown option '" << name << "' in " << src.name.c_str() << ", line " << line);
+		}
+	}
+	// Exclusive groups within this source; Required ones are checked on the merged options
+	for (const OptionGroup **g = &groups[0]; g < lastGroupPtr; ++g) {
+		if ( (*g)->flags & Group_Exclusive && nActiveGroupOptions[ g - &groups[0] ] > 1)
+			raiseError(ErrorMessage() << "Only one option may be chosen for OptionGroup '" << (*g)->desc << "' in " << src.name.c_str());
+	}
+}
+#endif
+
 }
 }
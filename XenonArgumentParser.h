@@ -1,15 +1,48 @@
 #pragma once
+/// ARGUMENT_PARSER_MINIMAL selects the smallest configuration: No STL containers or std::string,
+/// no iostreams (and their static initialization) and no exceptions.
+#ifdef ARGUMENT_PARSER_MINIMAL
+	#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+		#define ARGUMENT_PARSER_NO_STL_SUPPORT
+	#endif
+	#ifndef ARGUMENT_PARSER_NO_STRING
+		#define ARGUMENT_PARSER_NO_STRING
+	#endif
+	#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+		#define ARGUMENT_PARSER_NO_IOSTREAM
+	#endif
+	#ifndef ARGUMENT_PARSER_NO_EXCEPTIONS
+		#define ARGUMENT_PARSER_NO_EXCEPTIONS
+	#endif
+#endif
+
 #ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
 	#include <vector>
+	#include <memory>
+#endif
+#if !defined(ARGUMENT_PARSER_NO_STL_SUPPORT) || !defined(ARGUMENT_PARSER_NO_STRING)
+	#include <string>
+#endif
+#ifndef ARGUMENT_PARSER_NO_EXCEPTIONS
+	#include <stdexcept>
+	#include <string>
+#endif
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+	#include <iostream>
 #endif
-#include <stdexcept>
-#include <string>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <stddef.h>
 #include <stdint.h>
-#include <iostream>
+#include <cstdint>
 
 namespace Xenon {
 namespace ArgumentParser {
 
+/// @brief Maximum number of options in one options structure; Given options are tracked in a 64-bit mask
+static const unsigned int MaxOptions = 64;
+
 /// @brief Combinable flags for each single program option.
 enum OptionsFlags {
 	Options_None             = 0,
@@ -38,6 +71,9 @@ enum OptionParserFlags {
 	IgnoreUnknown  = 1U << 3,
 	/// When printing the help-page, use only one line per argument
 	CompactHelp    = 1U << 4,
+	/// Don't check for required options and OptionGroups; The arguments only give part of the options (e.g. for an overlay).
+	/// Dependencies are still checked; For an overlay, options of its base satisfy them.
+	PartialArguments = 1U << 5,
 };
 
 /// @brief Flags for OptionGroups
@@ -84,11 +120,12 @@ struct OptionDesc {
 	/// @brief Enumerations can be used if an option argument shall be selected from a given set of values
 	OptionDesc &setEnum (const char * const * const enum_values) {enumeration_values = enum_values; return *this; }
 	/// @brief Establish dependency from this option to another option. Don't call this method directly; Use the @link XE_DEPEND_ON macro instead.
-	OptionDesc &dependOn (int64_t option_bit) { depends_on |= option_bit; return *this; }
+	OptionDesc &dependOn (uint64_t option_bit) { depends_on |= option_bit; return *this; }
 	/// @brief Assign this attribute into an @link OptionGroup
 	OptionDesc &group (const OptionGroup &grp) { this->assignedGroup = &grp; return *this; }
 };
 
+#ifndef ARGUMENT_PARSER_NO_EXCEPTIONS
 /// @brief Thrown if a mandatory option is not given on the command line
 struct RequiredArgumentMissing : public std::exception
 {
@@ -105,22 +142,255 @@ struct ArgumentParserError : public std::runtime_error
 {
 	ArgumentParserError (const std::string &s) : runtime_error(s) { }
 };
+#else
+/// @brief Kind of error passed to the @link ErrorHandler
+enum ErrorKind {
+	/// Parsing failed because of a user-error
+	Error_Argument,
+	/// A mandatory option is not given on the command line
+	Error_RequiredArgumentMissing,
+	/// The options are declared incorrectly
+	Error_Logic,
+};
+
+/// @brief Called for errors if exceptions are disabled. Must not return; Parsing can not be continued.\n
+/// The default handler prints the message to stderr and exits the process with EXIT_FAILURE.
+typedef void (*ErrorHandler) (ErrorKind kind, const char *message);
+
+/// @brief Install a handler for parse errors. Returns the previous handler.
+ErrorHandler setErrorHandler (ErrorHandler handler);
+#endif
+
+/// @brief Composes error messages. If exceptions are disabled, a fixed-size buffer is used instead of a std::string
+/// to avoid allocation; Overlong messages are truncated then.
+class ErrorMessage {
+public:
+#ifndef ARGUMENT_PARSER_NO_EXCEPTIONS
+	ErrorMessage &operator<< (const char *s) { text += s; return *this; }
+	ErrorMessage &operator<< (char c) { text += c; return *this; }
+	const char *c_str () const { return text.c_str(); }
+private:
+	std::string text;
+#else
+	ErrorMessage () : len(0) { text[0] = '\0'; }
+	ErrorMessage &operator<< (const char *s) {
+		const size_t n = strnlen (s, sizeof(text) - 1 - len);
+		memcpy (&text[len], s, n);
+		text[len += n] = '\0';
+		return *this;
+	}
+	ErrorMessage &operator<< (char c) {
+		if (len < sizeof(text) - 1) {
+			text[len++] = c;
+			text[len] = '\0';
+		}
+		return *this;
+	}
+	const char *c_str () const { return text; }
+private:
+	char text[256];
+	size_t len;
+#endif
+};
+
+/// @brief Report a user-error. Throws @link ArgumentParserError, or calls the @link ErrorHandler if exceptions are disabled
+[[noreturn]] void raiseError (const char *message);
+[[noreturn]] inline void raiseError (const ErrorMessage &message) { raiseError (message.c_str()); }
+/// @brief Report a missing mandatory option. Throws @link RequiredArgumentMissing, or calls the @link ErrorHandler
+[[noreturn]] void raiseRequiredArgumentMissing (const char *arg);
+/// @brief Report incorrectly declared options. Throws std::logic_error, or calls the @link ErrorHandler
+[[noreturn]] void raiseLogicError (const char *message);
+
+/// @brief Destination of help and version output. Implement this to redirect the output anywhere.
+struct OutputSink {
+	virtual ~OutputSink () { }
+	virtual void write (const char *data, size_t length) = 0;
+	virtual void flush () { }
+};
+
+/// @brief Writes to a file descriptor with plain write(2). Used for standard output if iostreams are disabled.
+/// On platforms without POSIX, only standard output (1) and standard error (2) are supported, written through stdio.
+struct FdOutputSink : public OutputSink {
+	explicit FdOutputSink (int fd) : fd(fd) { }
+	void write (const char *data, size_t length);
+	
+	int fd;
+};
+
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+/// @brief Writes to a std::ostream
+struct OStreamSink : public OutputSink {
+	explicit OStreamSink (std::ostream &out) : out(out) { }
+	void write (const char *data, size_t length) { out.write (data, length); }
+	void flush () { out.flush(); }
+	
+	std::ostream &out;
+};
+#endif
+
+/// @brief Buffered formatting of help output into an @link OutputSink. Flushed on destruction.
+class OutputWriter {
+public:
+	explicit OutputWriter (OutputSink &sink) : sink(sink), used(0) { }
+	~OutputWriter () { flush(); }
+	
+	void write (const char *data, size_t length);
+	void flush ();
+	
+	OutputWriter &operator<< (const char *s) { write (s, strlen(s)); return *this; }
+	OutputWriter &operator<< (char c) { write (&c, 1); return *this; }
+	/// Booleans are printed as 0 or 1
+	OutputWriter &operator<< (bool b) { return *this << (char)('0' + b); }
+	OutputWriter &operator<< (int v) { return *this << (long long)v; }
+	OutputWriter &operator<< (long v) { return *this << (long long)v; }
+	OutputWriter &operator<< (long long v);
+	OutputWriter &operator<< (double v);
+#ifndef ARGUMENT_PARSER_NO_STRING
+	OutputWriter &operator<< (const std::string &s) { write (s.data(), s.size()); return *this; }
+#endif
+private:
+	OutputSink &sink;
+	char buffer[256];
+	size_t used;
+};
 
 /// @brief Structure used to control information about the application (it's name, version, and customization of it's help text)
 struct AppInformation
 {
 	unsigned int programOptions;
 	const char *programName, *programVersion, *programHelpTextHeader, *programHelpTextTail, *usage;
+	OutputSink *helpOutput; ///< If NULL; helpOutputStream is used, or standard output
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
 	std::ostream *helpOutputStream; ///< If NULL; default is std::cout
+#endif
 	
 	AppInformation (const char *appName, const char *version, unsigned int programOptions = 0)
 		: programOptions(programOptions), programName(appName), programVersion(version),
-		programHelpTextHeader(NULL), programHelpTextTail(NULL), usage(NULL), helpOutputStream(NULL) { }
+		programHelpTextHeader(NULL), programHelpTextTail(NULL), usage(NULL), helpOutput(NULL)
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+		, helpOutputStream(NULL)
+#endif
+		{ }
 	
 	AppInformation &setHelpText (const char *head, const char *tail = NULL) { programHelpTextHeader = head; programHelpTextTail = tail; return *this; }
 	AppInformation &setUsage (const char *txt) { usage = txt; return *this; }
 };
 
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+struct FileMapping;
+
+/**
+ * @brief Read-only string value which may be loaded from a file given as '@path'.
+ *
+ * If the argument starts with '@', the remainder is taken as a path and the file is memory-mapped;
+ * the view then refers directly to the mapped contents without copying them. On platforms without mmap,
+ * the file is read into storage owned by the view instead. The mapping is shared
+ * between all copies of the view and released with the last one, so it lives as long as the options
+ * structure holding it. Use '@@' to pass a literal value starting with '@'.
+ * Any other value refers to the argument string itself, which must outlive the view (as for const char * options);
+ * Values parsed from a command string are copied instead, as the parser reuses the memory of the arguments.
+ *
+ * For @link Options_Multiple options of type std::vector<FileView>, a mapped file is split in place into
+ * one element per non-empty line.
+ */
+class FileView {
+public:
+	FileView () : ptr(""), len(0) { }
+	FileView (const char *s) : ptr(s), len(strlen(s)) { }
+	FileView (const char *s, size_t n, const std::shared_ptr<const FileMapping> &m = std::shared_ptr<const FileMapping>())
+		: ptr(s), len(n), mapping(m) { }
+	
+	const char *data () const { return ptr; }
+	size_t size () const { return len; }
+	bool empty () const { return len == 0; }
+	const char *begin () const { return ptr; }
+	const char *end () const { return ptr + len; }
+	/// @brief True if this view refers to a memory-mapped file
+	bool isMapped () const;
+	/// @brief Sub-view sharing the same mapping
+	FileView substr (size_t pos, size_t n) const { return FileView (ptr + pos, n, mapping); }
+	/// @brief Copy the contents into a std::string. Note that the view is not NUL-terminated.
+	std::string str () const { return std::string (ptr, len); }
+	/// @brief View of a copy of the given data, owned by the view and all sub-views
+	static FileView copy (const char *s, size_t n);
+	
+	/// @brief True if the argument value refers to a file which shall be mapped
+	static bool isFileReference (const char *argValue) { return argValue && argValue[0] == '@' && argValue[1] != '@'; }
+private:
+	const char *ptr;
+	size_t len;
+	std::shared_ptr<const FileMapping> mapping;
+};
+
+inline OutputWriter &operator<< (OutputWriter &out, const FileView &v) { out.write (v.data(), v.size()); return out; }
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+inline std::ostream &operator<< (std::ostream &out, const FileView &v) { return out.write (v.data(), v.size()); }
+#endif
+
+/**
+ * @brief Splits a command string into an argument vector, following the quoting rules of a POSIX shell.
+ *
+ * Whitespace separates arguments; Single quotes preserve everything literally, double quotes preserve
+ * everything except backslash escapes of ", \, $, ` and newline. Outside of quotes, a backslash escapes any character.
+ * The arguments are written into a scratch buffer that is reused by the next call, so no allocation
+ * takes place once the buffer has grown to the longest command string.
+ */
+class CommandTokenizer {
+public:
+	/// @brief Tokenize the command string; Returns argc. argv()[0] is set to argv0.
+	/// The arguments remain valid until the next call.
+	int tokenize (const char *cmdline, size_t length, const char *argv0);
+	char **argv () { return &args[0]; }
+	/// @brief True if p points into the memory of the arguments
+	bool contains (const char *p) const { return !buffer.empty() && p >= &buffer[0] && p < &buffer[0] + buffer.size(); }
+private:
+	std::vector<char> buffer;
+	std::vector<char *> args;
+};
+
+/// @brief Internal helper used with for_each_option: Gives FileView values referring to the arguments of a
+/// command string their own copy, as the tokenizer reuses its memory for the next command
+struct CommandValueOwner {
+	explicit CommandValueOwner (const CommandTokenizer &tokenizer) : tokenizer(tokenizer) { }
+	
+	template<class T> void operator() (const OptionDesc &, T &, const T &) { }
+	void operator() (const OptionDesc &, FileView &v, const FileView &) { own (v); }
+	template<class Alloc>
+	void operator() (const OptionDesc &, std::vector<FileView, Alloc> &v, const std::vector<FileView, Alloc> &) {
+		for (FileView &f : v)
+			own (f);
+	}
+	void own (FileView &v) const {
+		if (tokenizer.contains (v.data()))
+			v = FileView::copy (v.data(), v.size());
+	}
+	
+	const CommandTokenizer &tokenizer;
+};
+#endif
+
+/// @brief Origin of an option value; See @link LayeredSources
+struct Provenance {
+	/// Id of the source, as returned when it was added. 0 if the compiled default value is used.
+	uint16_t source;
+	/// Index of the command-line argument, line of the config file or index of the environment variable
+	uint16_t position;
+};
+
+class LayeredSources;
+
+/// @brief Internal helper restoring a variable to its previous value when leaving the scope
+template<class T> struct ScopedRestore {
+	explicit ScopedRestore (T &ref) : ref(ref), saved(ref) { }
+	~ScopedRestore () { ref = saved; }
+	
+	T &ref;
+	const T saved;
+};
+
+/// @brief Internal helper to destroy values of any type, which may not be spelled as a destructor name (e.g. std::vector<int>)
+template<class T> inline void destroyValue (T *p) { p->~T(); }
+
 /// @brief Internal base class all parser classes use
 struct OptionParserBase
 {
@@ -128,8 +398,8 @@ struct OptionParserBase
 	struct HelpPrinter {
 		template<class T> void operator() (const OptionDesc &desc, const T &v, const T &d);
 		
-		HelpPrinter (std::ostream &o, const AppInformation & ai, bool f) : out(o), appInfo(ai), full(f), lastGroup(NULL) { }
-		std::ostream &out;
+		HelpPrinter (OutputWriter &o, const AppInformation & ai, bool f) : out(o), appInfo(ai), full(f), lastGroup(NULL) { }
+		OutputWriter &out;
 		const AppInformation &appInfo;
 		bool full;
 		const OptionGroup *lastGroup;
@@ -142,20 +412,126 @@ struct OptionParserBase
 		PARSE_TERMINATE = 2,
 	};
 	
+	OptionParserBase () : _opt_lockedParameters(0), _opt_baseParameters(0), _opt_provenance(NULL), _opt_deferChecks(false) {
+		_opt_origin.source = _opt_origin.position = 0;
+	}
+	
 	/// @brief Generate help page to out
-	virtual void printHelp (std::ostream &out, bool full, const AppInformation &appInfo) = 0;
+	void printHelp (OutputSink &out, bool full, const AppInformation &appInfo);
+#ifndef ARGUMENT_PARSER_NO_IOSTREAM
+	void printHelp (std::ostream &out, bool full, const AppInformation &appInfo) {
+		OStreamSink sink (out);
+		printHelp (sink, full, appInfo);
+	}
+#endif
 protected:
-	void printHelpHead (std::ostream &out, const AppInformation &appInfos);
+	void printHelpHead (OutputWriter &out, const AppInformation &appInfos);
 	
 	enum ParseFlags {
 		PARSE_IS_NEXT_ARG = 1,
+		/// Match the attribute name of the option instead of its command-line name (see OptionDesc::setName)
+		PARSE_ATTRIBUTE_NAME = 2,
 	};
 	ParseResult parse (int argc, char **argv, const AppInformation &appInfos);
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+	ParseResult parse (const char *cmdline, size_t length, const AppInformation &appInfos) {
+		const int argc = tokenizer.tokenize (cmdline, length, appInfos.programName);
+		return parse (argc, tokenizer.argv(), appInfos);
+	}
+	
+	CommandTokenizer tokenizer;
+	
+	ParseResult parse (LayeredSources &sources, const uint64_t &setParameters, const AppInformation &appInfos);
+	void applyEntries (const LayeredSources &sources, size_t sourceIndex, const AppInformation &appInfos);
+#endif
+	static void checkGroup (const OptionGroup *group, unsigned int nActiveOptions, const AppInformation &appInfos);
+	
+	/// @brief Called before converting the value of an option. Returns false if the option is locked by a source of higher priority;
+	/// Then the option is neither converted nor marked as set.
+	bool _opt_beginAssign (unsigned int param) {
+		if (_opt_lockedParameters & (uint64_t(1) << param))
+			return false;
+		if (_opt_provenance)
+			_opt_provenance[param] = _opt_origin;
+		return true;
+	}
+	
+	uint64_t _opt_lockedParameters;
+	/// Options given elsewhere (the base of an overlay); These satisfy dependencies
+	uint64_t _opt_baseParameters;
+	Provenance *_opt_provenance, _opt_origin;
+	/// If set, required options, dependencies and OptionGroups are checked once all sources are applied
+	bool _opt_deferChecks;
+	
 	virtual bool _opt_parseLongArgument (const char *argName, const char *argValue, OptionDesc *selectedArg, int parseFlags = 0) = 0;
 	virtual bool _opt_parseShortArgument (char arg, const char *argValue, OptionDesc *selectedArg) = 0;
 	virtual void _opt_checkArguments (char **argv, uint32_t numPositionalArgs, uint16_t *positionalArgs, const AppInformation &appInfo) = 0;
 	virtual void _opt_enumerateGroups (const OptionGroup **&groups, unsigned int maxGroups) = 0;
+	virtual void _opt_printOptions (HelpPrinter &printer) = 0;
+	virtual void _opt_checkGroups (const AppInformation &appInfo) = 0;
+	/// @brief All options of Group_Exclusive groups in which one of setParameters is given
+	virtual uint64_t _opt_exclusiveGroupParameters (uint64_t setParameters) = 0;
+};
+
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+/**
+ * @brief Option values from several sources (config files, environment variables, command line), applied in priority order.
+ *
+ * Sources added later take precedence over earlier ones; Options given by no source keep their default value.
+ * Parser::parse (opts, sources) applies all sources in one pass, starting with the source of highest priority:
+ * Each other source skips the options already set, without converting their values again. Once an option of a
+ * Group_Exclusive group is set, the other options of that group are skipped by sources of lower priority as well;
+ * Within a single source, at most one of them may be given.
+ * Required options, dependencies and OptionGroups are checked on the merged result.
+ * Afterwards, origin() tells for each option which source its value came from.
+ *
+ * Values of type const char * refer to the memory of the sources, which must outlive the options.
+ */
+class LayeredSources {
+public:
+	LayeredSources () { memset (provenance, 0, sizeof(provenance)); }
+	
+	/// @brief Add command-line arguments (argv[0] is skipped). Returns the source id.
+	uint16_t addArguments (int argc, char **argv, const char *name = "command line");
+	/// @brief Add a config file with lines of the form 'name = value', or just 'name' for flags. The name is the option's
+	/// attribute name, also if setName() gives another command-line name (e.g. 'merge_algo' for --merge-algorithm).
+	/// Empty lines and lines starting with '#' are ignored. Returns the source id.
+	uint16_t addConfigFile (const char *path, bool mustExist = true);
+	/// @brief Add all environment variables starting with prefix. For option 'log_level' and prefix 'MYAPP_',
+	/// the variable is named MYAPP_LOG_LEVEL. Variables not naming an option are ignored. Returns the source id.
+	/// If envp is NULL, the environment of the process is used; Other platforms than POSIX and Windows must pass envp.
+	uint16_t addEnvironment (const char *prefix, char **envp = NULL);
+	
+	/// @brief Origin of the value of an option (given by its PARAM_* value) after parsing
+	const Provenance &origin (unsigned int param) const { return provenance[param]; }
+	/// @brief Name of a source: "command line", the path of a config file, or "environment". "default" for source 0.
+	const char *sourceName (uint16_t source) const { return (source > 0 && source <= sources.size()) ? sources[source - 1].name.c_str() : "default"; }
+private:
+	friend struct OptionParserBase;
+	
+	/// @brief Name/value pair of a config file or the environment; Offsets into Source::text
+	struct Entry {
+		uint32_t name, value;
+		uint16_t position;
+	};
+	static const uint32_t NoValue = ~0U;
+	
+	struct Source {
+		std::string name;
+		int argc;
+		char **argv;
+		bool isEnvironment;
+		std::vector<char> text;
+		std::vector<Entry> entries;
+		
+		Source (const char *name) : name(name), argc(0), argv(NULL), isEnvironment(false) { }
+	};
+	uint16_t add (Source &&src);
+	
+	std::vector<Source> sources;
+	Provenance provenance[MaxOptions];
 };
+#endif
 
 /**
  * @brief Contains all the parsing functions for each type. Can be extended by the user to provide support for custom/additional types.
@@ -163,7 +539,9 @@ protected:
 namespace ParseFunctions {
 	typedef OptionParserBase::HelpPrinter OHP;
 	
+#ifndef ARGUMENT_PARSER_NO_STRING
 	void parse ( std::string &p, const char *argValue, const OptionDesc &desc );
+#endif
 	void parse ( const char * &p, const char *argValue, const OptionDesc &desc );
 	void parse ( int32_t &p, const char *argValue, const OptionDesc &desc );
 	void parse ( int64_t &p, const char *argValue, const OptionDesc &desc );
@@ -171,6 +549,8 @@ namespace ParseFunctions {
 	void parse ( bool &p, const char *argValue, const OptionDesc &desc );
 	
 #ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+	void parse ( FileView &p, const char *argValue, const OptionDesc &desc );
+	
 	/// Support for any vector of any type. Use push_back
 	template<class T, class Alloc>
 	void parse ( std::vector<T, Alloc> &p, const char *argValue, const OptionDesc &desc ) {
@@ -178,25 +558,68 @@ namespace ParseFunctions {
 		parse (val, argValue, desc);
 		p.push_back(val);
 	}
+	
+	/// A mapped file is split into one view per non-empty line, all referring to the same mapping
+	template<class Alloc>
+	void parse ( std::vector<FileView, Alloc> &p, const char *argValue, const OptionDesc &desc ) {
+		FileView val;
+		parse (val, argValue, desc);
+		if (!FileView::isFileReference (argValue)) {
+			p.push_back(val);
+			return;
+		}
+		for (const char *s = val.begin(), *e; s < val.end(); s = e + 1) {
+			e = static_cast<const char *> (memchr (s, '\n', val.end() - s));
+			if (!e)
+				e = val.end();
+			const char *lineEnd = (e > s && e[-1] == '\r') ? e - 1 : e;
+			if (lineEnd > s)
+				p.push_back (val.substr (s - val.data(), lineEnd - s));
+		}
+	}
 #endif
 
+#ifndef ARGUMENT_PARSER_NO_STRING
 	void print_help (OHP &, const OptionDesc &desc, const std::string &, const std::string &defVal);
-	void print_help (OHP &, const OptionDesc &desc, const char* &, const char* &defVal);
+#endif
+	void print_help (OHP &, const OptionDesc &desc, const char * const &, const char * const &defVal);
 	void print_help (OHP &, const OptionDesc &desc, int32_t, int32_t defVal);
 	void print_help (OHP &, const OptionDesc &desc, int64_t, int64_t defVal);
 	void print_help (OHP &, const OptionDesc &desc, float, float defVal);
 	void print_help (OHP &, const OptionDesc &desc, bool, bool defVal);
 	
 #ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+	void print_help (OHP &, const OptionDesc &desc, const FileView &, const FileView &defVal);
+	
 	template<class T, class Alloc>
 	void print_help (OHP &hp, const OptionDesc &desc, const std::vector<T, Alloc> &, const std::vector<T, Alloc> &) {
 		const T val;
 		print_help (hp, desc, val, val);
 	}
 #endif
+	
+	/// Restore the default value of an option
+	template<class T, class D>
+	void reset ( T &p, const D &defVal ) {
+		p = defVal;
+	}
+	
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+	/// Keeps the capacity of the vector, so it can be refilled without allocation
+	template<class T, class Alloc, class D>
+	void reset ( std::vector<T, Alloc> &p, const D &defVal ) {
+		p.assign (defVal.begin(), defVal.end());
+	}
+#endif
 
 };
 
+/// @brief Restore all default values of an options structure and clear its set parameters. Keeps allocated memory where possible.
+template<class Options>
+inline void resetOptions (Options &opts) {
+	opts._opt_reset ();
+}
+
 template<class T>
 void OptionParserBase::HelpPrinter::operator() (const OptionDesc &desc, const T &v, const T &d) {
 	ParseFunctions::print_help (*this, desc, v, d);
@@ -219,7 +642,9 @@ struct OPTIONS_CLASS_NAME \
 	\
 	enum _opt_Parameters {     \
 		OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_DEF_FLAG)     \
+		_opt_NumParameters \
 	};     \
+	static_assert (_opt_NumParameters <= Xenon::ArgumentParser::MaxOptions, "ArgumentParser: Too many options. Only 64 are allowed"); \
 	\
 	template<class F>     \
 	void for_each_option (F &_opt_f) {     \
@@ -229,6 +654,85 @@ struct OPTIONS_CLASS_NAME \
 	\
 	OPTIONS_CLASS_NAME ()     \
 		: setParameters(0) OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_INIT_VAL)   {}     \
+	\
+	/** @brief Use Xenon::ArgumentParser::resetOptions (opts) */ \
+	void _opt_reset () {     \
+		setParameters = 0; \
+		OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_RESET_VAL)     \
+	}     \
+	\
+	/** @brief Copy-on-write profile on top of a shared, immutable base structure. \
+	 * Only the overridden options are stored, in one compact block; all others are read from the base, \
+	 * which must outlive the overlay. Accessors have the same names as the options and take constant time. \
+	 * Fill it with Parser::parse (overlay, argc, argv). */ \
+	struct Overlay { \
+		explicit Overlay (const OPTIONS_CLASS_NAME &base) : setParameters(0), _opt_resetParameters(0), _opt_base(&base), _opt_storage(NULL) { } \
+		Overlay (Overlay &&o) : setParameters(0), _opt_resetParameters(0), _opt_base(o._opt_base), _opt_storage(NULL) { *this = std::move (o); } \
+		Overlay &operator= (Overlay &&o) { \
+			if (this != &o) { \
+				_opt_clear(); \
+				setParameters = o.setParameters; \
+				_opt_resetParameters = o._opt_resetParameters; \
+				_opt_base = o._opt_base; \
+				_opt_storage = o._opt_storage; \
+				memcpy (_opt_offsets, o._opt_offsets, sizeof(_opt_offsets)); \
+				o.setParameters = 0; \
+				o._opt_storage = NULL; \
+			} \
+			return *this; \
+		} \
+		Overlay (const Overlay &) = delete; \
+		Overlay &operator= (const Overlay &) = delete; \
+		~Overlay () { _opt_clear(); } \
+		\
+		/** @brief Bitmask of the overridden options */ \
+		uint64_t setParameters; \
+		OPTION_LIST_MACRO_NAME(XE_ARG_OVERLAY_ACCESSOR)     \
+		\
+		/* Members are named _opt_* so they can not collide with accessors of options */ \
+		/** @brief The shared base structure */ \
+		const OPTIONS_CLASS_NAME &_opt_getBase () const { return *_opt_base; } \
+		/** @brief True if the overlay stores its own value for option p (given by its PARAM_* value) */ \
+		bool _opt_overrides (_opt_Parameters p) const { return setParameters & (uint64_t(1) << p); } \
+		\
+		/** @brief Replace the overridden options with all options given (has_*) in values. \
+		 * The options in resetParameters are overridden with their value in values as well, but count as not given. */ \
+		void _opt_assign (const OPTIONS_CLASS_NAME &values, uint64_t resetParameters = 0) {     \
+			const uint64_t _opt_assigned = _opt_allocate (values, resetParameters); \
+			OPTION_LIST_MACRO_NAME(XE_ARG_OVERLAY_COPY)     \
+		}     \
+		/** @brief Same as above, but moves the values of the given options instead of copying them */ \
+		void _opt_assign (OPTIONS_CLASS_NAME &&values, uint64_t resetParameters = 0) {     \
+			const uint64_t _opt_assigned = _opt_allocate (values, resetParameters); \
+			OPTION_LIST_MACRO_NAME(XE_ARG_OVERLAY_MOVE)     \
+		}     \
+		/** @brief Drop all overridden options */ \
+		void _opt_clear () {     \
+			OPTION_LIST_MACRO_NAME(XE_ARG_OVERLAY_DESTROY)     \
+			setParameters = _opt_resetParameters = 0; \
+			::operator delete (_opt_storage); \
+			_opt_storage = NULL; \
+		}     \
+	private: \
+		/* Drops the overridden options and lays out the storage for the options to assign; Returns their bitmask */ \
+		uint64_t _opt_allocate (const OPTIONS_CLASS_NAME &values, uint64_t resetParameters) {     \
+			_opt_clear(); \
+			const uint64_t _opt_assigned = values.setParameters | resetParameters; \
+			size_t _opt_size = 0; \
+			OPTION_LIST_MACRO_NAME(XE_ARG_OVERLAY_LAYOUT)     \
+			if (_opt_size) \
+				_opt_storage = static_cast<char *> (::operator new (_opt_size)); \
+			_opt_resetParameters = resetParameters & ~values.setParameters; \
+			return _opt_assigned; \
+		}     \
+		\
+		/* Overridden options which count as not given */ \
+		uint64_t _opt_resetParameters; \
+		const OPTIONS_CLASS_NAME *_opt_base; \
+		char *_opt_storage; \
+		uint32_t _opt_offsets[(_opt_NumParameters > 0) ? _opt_NumParameters : 1]; \
+	}; \
+	\
 	typedef OPTIONS_CLASS_NAME##_Parser Parser; \
 	typedef OPTIONS_CLASS_NAME _XE_OPT_DATA; \
 }; \
@@ -237,22 +741,30 @@ struct OPTIONS_CLASS_NAME##_Parser : public Xenon::ArgumentParser::OptionParserB
 	\
 	typedef Xenon::ArgumentParser::OptionDesc OptionDesc; \
 	typedef OPTIONS_CLASS_NAME _XE_OPT_DATA; \
-	void printHelp (std::ostream &out, bool full, const Xenon::ArgumentParser::AppInformation &appInfo) {     \
-		using namespace Xenon::ArgumentParser; \
-		printHelpHead(out, appInfo);     \
-		HelpPrinter printer (out, appInfo, full); \
-		data->for_each_option(printer);     \
-		if (appInfo.programHelpTextTail) \
-			out << appInfo.programHelpTextTail; \
-		out << std::endl; \
-	}     \
-	\
 	ParseResult parse (OPTIONS_CLASS_NAME &opts, int argc, char **argv) { \
 		this->data = &opts; \
 		return this->OptionParserBase::parse (argc, argv, *this); \
 	} \
+	_XE_OPTIONS_CMDLINE_PARSE(OPTIONS_CLASS_NAME) \
+	_XE_OPTIONS_LAYERED_PARSE(OPTIONS_CLASS_NAME) \
+	/** @brief Parse a partial argument list into an overlay. Required options are not checked; Dependencies may be given by the base. \
+	 * If an option of a Group_Exclusive group is given, the other options of that group set by the base are overridden \
+	 * with their default value and count as not given; Options of the base depending on them fail the parse. */ \
+	ParseResult parse (OPTIONS_CLASS_NAME::Overlay &overlay, int argc, char **argv) { \
+		OPTIONS_CLASS_NAME values; \
+		Xenon::ArgumentParser::AppInformation appInfo (*this); \
+		appInfo.programOptions |= Xenon::ArgumentParser::PartialArguments; \
+		Xenon::ArgumentParser::ScopedRestore<OPTIONS_CLASS_NAME *> _opt_restoreData (this->data); \
+		Xenon::ArgumentParser::ScopedRestore<uint64_t> _opt_restoreBase (this->_opt_baseParameters); \
+		this->data = &values; \
+		this->_opt_baseParameters = overlay._opt_getBase().setParameters; \
+		const ParseResult result = this->OptionParserBase::parse (argc, argv, appInfo); \
+		const uint64_t _opt_reset = this->_opt_exclusiveGroupParameters (values.setParameters) & ~values.setParameters & this->_opt_baseParameters; \
+		overlay._opt_assign (std::move (values), _opt_reset); \
+		return result; \
+	} \
 	OPTIONS_CLASS_NAME##_Parser (const char *appName, const char *version, unsigned int programOptions = 0) \
-		: AppInformation(appName, version, programOptions) { } \
+		: AppInformation(appName, version, programOptions), data(NULL) { } \
 protected:     \
 	OPTIONS_CLASS_NAME *data; \
 	\
@@ -260,6 +772,9 @@ protected:     \
 	bool _opt_parseShortArgument (char arg, const char *argValue, OptionDesc *selectedArg);     \
 	void _opt_checkArguments (char **argv, uint32_t numPositionalArgs, uint16_t *positionalArgs, const Xenon::ArgumentParser::AppInformation &);     \
 	void _opt_enumerateGroups (const Xenon::ArgumentParser::OptionGroup **&groups, unsigned int maxGroups); \
+	void _opt_printOptions (HelpPrinter &printer) { data->for_each_option(printer); } \
+	void _opt_checkGroups (const Xenon::ArgumentParser::AppInformation &); \
+	uint64_t _opt_exclusiveGroupParameters (uint64_t setParameters); \
 };
 
 /**
@@ -291,8 +806,29 @@ void OPTIONS_CLASS_NAME##_Parser::_opt_checkArguments (char **_opt_argv, uint32_
 	unsigned int _opt_nextPositionalArg = 0; \
 	OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_POSITIONAL_ARGUMENTS)      \
 	if ((_opt_nextPositionalArg < _opt_numPositionalArgs) && !(appInfo.programOptions & Xenon::ArgumentParser::IgnoreUnknown))  \
-		throw ArgumentParserError(std::string("Too many positional arguments"));    \
-	OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_CHECK_ARGUMENTS)      \
+		raiseError("Too many positional arguments");    \
+	if (!this->_opt_deferChecks) { \
+		/* Options of the base (of an overlay) count, unless the arguments choose another option of their exclusive group */ \
+		const uint64_t _opt_givenParameters = this->data->setParameters | (this->_opt_baseParameters \
+			? (this->_opt_baseParameters & ~this->_opt_exclusiveGroupParameters (this->data->setParameters)) : 0); \
+		OPTION_LIST_MACRO_NAME(XE_ARG_PARSE_OPTIONS_CHECK_ARGUMENTS)      \
+	} \
+}\
+void OPTIONS_CLASS_NAME##_Parser::_opt_checkGroups (const Xenon::ArgumentParser::AppInformation &appInfo) {\
+	using namespace Xenon::ArgumentParser; \
+	const OptionGroup *_opt_group = NULL; \
+	unsigned int _opt_nActive = 0; \
+	OPTION_LIST_MACRO_NAME(XE_ARG_CHECK_GROUPS)      \
+	checkGroup (_opt_group, _opt_nActive, appInfo); \
+}\
+uint64_t OPTIONS_CLASS_NAME##_Parser::_opt_exclusiveGroupParameters (uint64_t _opt_setParameters) {\
+	using namespace Xenon::ArgumentParser; \
+	const OptionGroup *_opt_group = NULL; \
+	uint64_t _opt_groupParameters = 0, _opt_result = 0; \
+	OPTION_LIST_MACRO_NAME(XE_ARG_EXCLUSIVE_GROUP_PARAMETERS)      \
+	if (_opt_group && (_opt_group->flags & Group_Exclusive) && (_opt_groupParameters & _opt_setParameters)) \
+		_opt_result |= _opt_groupParameters; \
+	return _opt_result; \
 }\
 void OPTIONS_CLASS_NAME##_Parser::_opt_enumerateGroups (const Xenon::ArgumentParser::OptionGroup **&_opt_group, unsigned int _opt_maxGroups) {\
 	using namespace Xenon::ArgumentParser; \
@@ -306,13 +842,43 @@ void OPTIONS_CLASS_NAME##_Parser::_opt_enumerateGroups (const Xenon::ArgumentPar
 #define XE_DECLARE_OPTIONS_GROUP(GROUP_NAME, GROUP_DESC, GROUP_FLAGS) const Xenon::ArgumentParser::OptionGroup GROUP_NAME (GROUP_DESC, GROUP_FLAGS);
 
 /// @brief Declare dependency on an option. To be used like: DEF(name, type, OptionDesc(desc, ...).XE_DEPEND_ON( dependent_option )
-#define XE_DEPEND_ON(OPTION_NAME) dependOn ( (1U << _XE_OPT_DATA::PARAM_##OPTION_NAME) )
+#define XE_DEPEND_ON(OPTION_NAME) dependOn ( (uint64_t(1) << _XE_OPT_DATA::PARAM_##OPTION_NAME) )
 
 #define _XE_OPTIONS_str(s) #s
 
+/// PRIVATE: Parse functions for command strings, e.g. received from a control socket.
+/// One parser instance may be used for any number of commands; Use resetOptions() on the options structure between them.
+/// Values of type const char * refer to the parser's scratch buffer and are only valid until the next command is parsed;
+/// FileView values given inline are copied after parsing, so they stay valid as long as the options structure.
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+#define _XE_OPTIONS_CMDLINE_PARSE(OPTIONS_CLASS_NAME) \
+	ParseResult parse (OPTIONS_CLASS_NAME &opts, const char *cmdline, size_t length) { \
+		this->data = &opts; \
+		const ParseResult result = this->OptionParserBase::parse (cmdline, length, *this); \
+		Xenon::ArgumentParser::CommandValueOwner _opt_owner (this->tokenizer); \
+		opts.for_each_option (_opt_owner); \
+		return result; \
+	} \
+	ParseResult parse (OPTIONS_CLASS_NAME &opts, const char *cmdline) { return parse (opts, cmdline, strlen(cmdline)); } \
+	ParseResult parse (OPTIONS_CLASS_NAME &opts, const std::string &cmdline) { return parse (opts, cmdline.data(), cmdline.size()); }
+#else
+#define _XE_OPTIONS_CMDLINE_PARSE(OPTIONS_CLASS_NAME)
+#endif
+
+/// PRIVATE: Parse function for @link LayeredSources
+#ifndef ARGUMENT_PARSER_NO_STL_SUPPORT
+#define _XE_OPTIONS_LAYERED_PARSE(OPTIONS_CLASS_NAME) \
+	ParseResult parse (OPTIONS_CLASS_NAME &opts, Xenon::ArgumentParser::LayeredSources &sources) { \
+		this->data = &opts; \
+		return this->OptionParserBase::parse (sources, opts.setParameters, *this); \
+	}
+#else
+#define _XE_OPTIONS_LAYERED_PARSE(OPTIONS_CLASS_NAME)
+#endif
+
 /// PRIVATE:
 #define XE_ARG_PARSE_OPTIONS_DEF_MEMBER(var_name, type, desc, def) type var_name; \
-		bool has_##var_name () const { return setParameters & (1U << PARAM_##var_name); }
+		bool has_##var_name () const { return setParameters & (uint64_t(1) << PARAM_##var_name); }
 
 #define XE_ARG_PARSE_OPTIONS_DEF_FLAG(var_name, type, desc, def) PARAM_##var_name,
 
@@ -320,12 +886,49 @@ void OPTIONS_CLASS_NAME##_Parser::_opt_enumerateGroups (const Xenon::ArgumentPar
 
 #define XE_ARG_PARSE_OPTIONS_INIT_VAL(var_name, type, desc, def) , var_name(def)
 
+#define XE_ARG_PARSE_OPTIONS_RESET_VAL(var_name, type, desc, def) Xenon::ArgumentParser::ParseFunctions::reset (this->var_name, def);
+
+#define XE_ARG_OVERLAY_ACCESSOR(var_name, type, desc, def) \
+	typedef type _opt_type_##var_name; \
+	const _opt_type_##var_name &var_name () const { \
+		return (setParameters & (uint64_t(1) << PARAM_##var_name)) \
+			? *reinterpret_cast<const _opt_type_##var_name *> (_opt_storage + _opt_offsets[PARAM_##var_name]) : _opt_base->var_name; \
+	} \
+	bool has_##var_name () const { \
+		return ((setParameters & ~_opt_resetParameters) | (_opt_base->setParameters & ~setParameters)) & (uint64_t(1) << PARAM_##var_name); \
+	}
+
+#define XE_ARG_OVERLAY_LAYOUT(var_name, type, desc, def) \
+	if (_opt_assigned & (uint64_t(1) << PARAM_##var_name)) { \
+		_opt_size = (_opt_size + alignof(_opt_type_##var_name) - 1) & ~(alignof(_opt_type_##var_name) - 1); \
+		_opt_offsets[PARAM_##var_name] = _opt_size; \
+		_opt_size += sizeof(_opt_type_##var_name); \
+	}
+
+#define XE_ARG_OVERLAY_COPY(var_name, type, desc, def) \
+	if (_opt_assigned & (uint64_t(1) << PARAM_##var_name)) { \
+		new (_opt_storage + _opt_offsets[PARAM_##var_name]) _opt_type_##var_name (values.var_name); \
+		setParameters |= (uint64_t(1) << PARAM_##var_name); \
+	}
+
+#define XE_ARG_OVERLAY_MOVE(var_name, type, desc, def) \
+	if (_opt_assigned & (uint64_t(1) << PARAM_##var_name)) { \
+		new (_opt_storage + _opt_offsets[PARAM_##var_name]) _opt_type_##var_name (std::move (values.var_name)); \
+		setParameters |= (uint64_t(1) << PARAM_##var_name); \
+	}
+
+#define XE_ARG_OVERLAY_DESTROY(var_name, type, desc, def) \
+	if (setParameters & (uint64_t(1) << PARAM_##var_name)) \
+		Xenon::ArgumentParser::destroyValue (reinterpret_cast<_opt_type_##var_name *> (_opt_storage + _opt_offsets[PARAM_##var_name]));
+
 #define XE_ARG_PARSE_OPTIONS_DEF_DO_PARSE(var_name, type, desc, def) \
-	if ( strcmp (argName, (desc).setName( _XE_OPTIONS_str(var_name)).name) == 0) { \
+	if ( strcmp (argName, (parseFlags & PARSE_ATTRIBUTE_NAME) ? _XE_OPTIONS_str(var_name) : (desc).setName( _XE_OPTIONS_str(var_name)).name) == 0) { \
 		if ( (parseFlags & PARSE_IS_NEXT_ARG) && ((desc).flags & Options_Flag)) \
 			argValue = NULL; \
-		ParseFunctions::parse ( this->data->var_name, argValue, (desc).setName( _XE_OPTIONS_str(var_name))); \
-		this->data->setParameters |= (1U << this->data->PARAM_##var_name); \
+		if (this->_opt_beginAssign (this->data->PARAM_##var_name)) { \
+			ParseFunctions::parse ( this->data->var_name, argValue, (desc).setName( _XE_OPTIONS_str(var_name))); \
+			this->data->setParameters |= (uint64_t(1) << this->data->PARAM_##var_name); \
+		} \
 		*selectedArg = desc; \
 	} else
 
@@ -333,36 +936,67 @@ void OPTIONS_CLASS_NAME##_Parser::_opt_enumerateGroups (const Xenon::ArgumentPar
 	if ( arg == (desc).shortOption ) { \
 		if (((desc).flags & Options_Flag)) \
 			argValue = NULL; \
-		ParseFunctions::parse ( this->data->var_name, argValue, (desc).setName( _XE_OPTIONS_str(var_name) ) ); \
-		this->data->setParameters |= (1U << this->data->PARAM_##var_name); \
+		if (this->_opt_beginAssign (this->data->PARAM_##var_name)) { \
+			ParseFunctions::parse ( this->data->var_name, argValue, (desc).setName( _XE_OPTIONS_str(var_name) ) ); \
+			this->data->setParameters |= (uint64_t(1) << this->data->PARAM_##var_name); \
+		} \
 		*selectedArg = desc; \
 	} else
 
 #define XE_ARG_PARSE_OPTIONS_POSITIONAL_ARGUMENTS(var_name, type, desc, def) \
-	if ((((desc).flags) & Options_Positional) && (!data->has_##var_name() || ((desc).flags & Options_Multiple)) && _opt_nextPositionalArg < _opt_numPositionalArgs) { \
+	if ((((desc).flags) & Options_Positional) && (!data->has_##var_name() || ((desc).flags & Options_Multiple) \
+			|| (this->_opt_lockedParameters & (uint64_t(1) << this->data->PARAM_##var_name))) && _opt_nextPositionalArg < _opt_numPositionalArgs) { \
+		this->_opt_origin.position = _opt_positionalArgs[_opt_nextPositionalArg]; \
+		const bool _opt_convert = this->_opt_beginAssign (this->data->PARAM_##var_name); \
 		do { \
-			ParseFunctions::parse ( this->data->var_name, _opt_argv[_opt_positionalArgs[_opt_nextPositionalArg++]], (desc).setName( _XE_OPTIONS_str(var_name) ) ); \
+			const char *_opt_value = _opt_argv[_opt_positionalArgs[_opt_nextPositionalArg++]]; \
+			if (_opt_convert) \
+				ParseFunctions::parse ( this->data->var_name, _opt_value, (desc).setName( _XE_OPTIONS_str(var_name) ) ); \
 		} while ((_opt_nextPositionalArg < _opt_numPositionalArgs) && ((desc).flags & Options_Multiple)); \
-		this->data->setParameters |= (1U << this->data->PARAM_##var_name); \
+		if (_opt_convert) \
+			this->data->setParameters |= (uint64_t(1) << this->data->PARAM_##var_name); \
 	} \
 
 #define XE_ARG_PARSE_OPTIONS_CHECK_ARGUMENTS(var_name, type, macro_desc, def) \
 	{ \
-		OptionDesc &odesc = (macro_desc).setName( _XE_OPTIONS_str(var_name) ); \
-		if (((odesc.flags) & Options_Required) && !data->has_##var_name()) { \
-			throw RequiredArgumentMissing( _XE_OPTIONS_str(var_name) ); \
+		const OptionDesc odesc = (macro_desc).setName( _XE_OPTIONS_str(var_name) ); \
+		if (((odesc.flags) & Options_Required) && !data->has_##var_name() && !(appInfo.programOptions & PartialArguments)) { \
+			raiseRequiredArgumentMissing( _XE_OPTIONS_str(var_name) ); \
 		} \
-		if ( data->has_##var_name() && (odesc.depends_on & ~this->data->setParameters )) { \
-			throw ArgumentParserError ( std::string("OptionsParser: Option '") + std::string(odesc.name) + "' depends on options that are not given"); \
+		if ( (_opt_givenParameters & (uint64_t(1) << this->data->PARAM_##var_name)) && (odesc.depends_on & ~_opt_givenParameters)) { \
+			raiseError ( ErrorMessage() << "OptionsParser: Option '" << odesc.name << "' depends on options that are not given"); \
 		} \
 	}
 	
+#define XE_ARG_CHECK_GROUPS(var_name, type, macro_desc, def) \
+	{ \
+		const OptionGroup *g = (macro_desc).assignedGroup; \
+		if (g != _opt_group) { \
+			checkGroup (_opt_group, _opt_nActive, appInfo); \
+			_opt_group = g; \
+			_opt_nActive = 0; \
+		} \
+		_opt_nActive += data->has_##var_name(); \
+	}
+
+#define XE_ARG_EXCLUSIVE_GROUP_PARAMETERS(var_name, type, macro_desc, def) \
+	{ \
+		const OptionGroup *g = (macro_desc).assignedGroup; \
+		if (g != _opt_group) { \
+			if (_opt_group && (_opt_group->flags & Group_Exclusive) && (_opt_groupParameters & _opt_setParameters)) \
+				_opt_result |= _opt_groupParameters; \
+			_opt_group = g; \
+			_opt_groupParameters = 0; \
+		} \
+		_opt_groupParameters |= (uint64_t(1) << _XE_OPT_DATA::PARAM_##var_name); \
+	}
+
 #define XE_ARG_VISIT_GROUPS(var_name, type, macro_desc, def) \
 	{ \
 		const OptionGroup *g = (macro_desc).assignedGroup; \
 		if (g && g != _opt_prev) {\
 			if (++_opt_nGroups > _opt_maxGroups)\
-				throw std::logic_error ("ArgumentParser: Too many OptionGroups. Only 32 are allowed"); \
+				raiseLogicError ("ArgumentParser: Too many OptionGroups. Only 32 are allowed"); \
 			*(_opt_group++) = _opt_prev = g; \
 		} \
 	}
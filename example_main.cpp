@@ -2,6 +2,8 @@
 #include "XenonArgumentParser.h"
 #include <cstring>
 
+typedef Xenon::ArgumentParser::FileView FileView;
+
 const char *indentationValues[] = { "tabs", "spaces", "none", 0 };
 const char *numIterations[] = { "1", "2", "3", "4", 0 };
 const char *mergeAlgos[] = { "resolve", "recursive", "subtree", "ours", "octopus", 0 };
@@ -19,6 +21,8 @@ XE_DECLARE_OPTIONS_GROUP(GroupPerformance, "Performance options", 0);
 			Options_Required | Options_Multiple | Options_Positional, 'f').group(GenOptions), std::vector<std::string>())  \
 	DEF(path, std::string, OptionDesc("Base path to change into", Options_None).group(GenOptions), "") \
 	DEF(output, std::string, OptionDesc("output filepath", Options_Flag, 'o').group(GenOptions), "test.txt") \
+	DEF(keys, std::vector<FileView>, OptionDesc("Key to use; Give @path to load a list of keys from a file", \
+			Options_Multiple, 'k').group(GenOptions), std::vector<FileView>())  \
 	DEF(log, std::string, OptionDesc("Path to logfile. If not given, log to stdout", Options_None).group(GenOptions), "") \
 	DEF(verbosity, int, OptionDesc("Log verbosity level (Value between 0 and 20)", Options_None, 'v').group(GenOptions), 6) \
 	\
@@ -68,6 +72,18 @@ int main(int argc, char **argv) {
 	if (opt.print) {
 		std::cout << "Printing all assigned values:\n";
 		CREATE_MY_OPTIONLIST(PRINT_MY_OPTION)
+
+		// A profile on top of the given options: As merge and split are exclusive, it can choose the other mode.
+		// It is rejected if the base gives --merge-algorithm, which depends on --merge.
+		char *profileArgs[] = { argv[0], const_cast<char *> (opt.merge ? "--split" : "--merge"), NULL };
+		MyOptions::Overlay profile (opt);
+		MyOptions::Parser parser ("ExampleOptionParser", "0.1");
+		try {
+			parser.parse (profile, 2, profileArgs);
+			std::cout << "Profile operation mode: " << (profile.merge() ? "merge" : "split") << "\n";
+		} catch (const std::exception &e) {
+			std::cout << "Profile rejected: " << e.what() << "\n";
+		}
 	}
 	
 	if (opt.merge) {
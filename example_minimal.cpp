@@ -0,0 +1,36 @@
+// Example for the minimal configuration: No iostreams, exceptions or STL types.
+// Build with -DARGUMENT_PARSER_MINIMAL (for all translation units, including XenonArgumentParser.cpp)
+#include "XenonArgumentParser.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+const char *colorValues[] = { "auto", "always", "never", 0 };
+
+#define CREATE_MINIMAL_OPTIONLIST(DEF) \
+	DEF(input, const char *, OptionDesc("Input file", Options_Required | Options_Positional, 'i'), "") \
+	DEF(color, const char *, OptionDesc("Colorize output", Options_None).setEnum( colorValues ), "auto") \
+	DEF(count, int, OptionDesc("Number of repetitions", Options_None, 'n'), 1) \
+	DEF(ratio, float, OptionDesc("Some ratio", Options_None), 0.5f) \
+	DEF(quiet, bool, OptionDesc("Suppress output", Options_Flag, 'q'), false)
+
+XE_DECLARE_PROGRAM_OPTIONS(MinimalOptions, CREATE_MINIMAL_OPTIONLIST);
+XE_DEFINE_PROGRAM_OPTIONS_IMPL(MinimalOptions, CREATE_MINIMAL_OPTIONLIST);
+
+static void onError (Xenon::ArgumentParser::ErrorKind, const char *message) {
+	fprintf (stderr, "minimal: %s\nTry --help\n", message);
+	exit (2);
+}
+
+int main(int argc, char **argv) {
+	Xenon::ArgumentParser::setErrorHandler (&onError);
+	MinimalOptions opt;
+	MinimalOptions::Parser parser ("MinimalExample", "0.1", Xenon::ArgumentParser::CompactHelp);
+	if (parser.parse (opt, argc, argv) == MinimalOptions::Parser::PARSE_TERMINATE)
+		return 0;
+	
+	if (!opt.quiet) {
+		for (int i = 0; i < opt.count; ++i)
+			printf ("%s (color: %s, ratio: %g)\n", opt.input, opt.color, opt.ratio);
+	}
+	return 0;
+}